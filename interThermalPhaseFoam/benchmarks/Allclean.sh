@@ -0,0 +1,4 @@
+#!/bin/bash
+#Removes the benchmark runs; stored baselines are kept
+cd ${0%/*} || exit 1    # run from this directory
+rm -rf run
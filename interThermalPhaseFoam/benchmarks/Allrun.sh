@@ -0,0 +1,504 @@
+#!/bin/bash
+#Offline benchmark and validation suite for interThermalPhaseChangeFoam
+#Each case is built from the inputs in ../tutorials, run for a fixed number of
+#time steps in serial and decomposed, and its time per step, per-stage times,
+#peak memory, and solver iterations are collected in a CSV file that is
+#compared against a stored baseline. With -accuracy, the cases are run with
+#their own time stepping and the results are checked against the analytical
+#solutions and correlations of the Check*.m scripts. Cases in cases/ are
+#variants of a tutorial (named in their baseTutorial file), with their own
+#files replacing the tutorial inputs.
+#Run ./Allrun.sh -help for the options.
+cd ${0%/*} || exit 1    # run from this directory
+
+BENCHDIR=`pwd`
+TUTORIALS=$BENCHDIR/../tutorials
+SOLVER=interThermalPhaseChangeFoam
+MPIRUN=${MPIRUN:-mpirun}
+
+#Defaults
+CASES="Stefan NusseltSmooth NusseltWavy BubbleCondensation NucleateBoiling2D BubbleCondensation3D"
+NPROCS="1 4"
+SCALES="1"
+WEAK=no
+STEPS=200
+WARMUP=10
+ACCURACY=no
+IMPLICITENERGY=no
+MAXFOURIERIMPLICIT=
+ENDTIME=
+PHYSTOL=
+TOL=0.1
+ERRTOL=0.005
+BUILD=no
+OUTDIR=$BENCHDIR/run
+BASELINE=$BENCHDIR/baselines/`hostname -s`.csv
+UPDATEBASELINE=no
+
+#Default physics tolerances, from the errors quoted for the tutorials
+physicsTol()
+{
+	if [ -n "$PHYSTOL" ]
+	then
+		echo $PHYSTOL
+		return
+	fi
+	case $1 in
+		Stefan)             echo 0.15 ;;
+		NusseltSmooth)      echo 0.05 ;;
+		NusseltWavy)        echo 0.15 ;;
+		BubbleCondensation) echo 0.25 ;;
+	esac
+}
+
+usage()
+{
+	cat <<USAGE
+
+Usage: ${0##*/} [OPTION]
+options:
+  -cases "A B ..."   cases to run (default: $CASES)
+  -np "1 4 ..."      processor counts, 1 runs serial (default: $NPROCS)
+  -scale "1 2 ..."   mesh refinement factors per direction (default: $SCALES)
+  -weak              weak scaling: also refine the mesh by sqrt(np) per
+                     direction so the cells per processor stay fixed
+  -steps N           time steps per performance run (default: $STEPS)
+  -warmup N          leading steps left out of the averages (default: $WARMUP)
+  -accuracy          run with the case time stepping and check the physics
+  -endTime T         end time for -accuracy runs (default: the case endTime)
+  -implicitEnergy    run with implicitEnergy yes in the PIMPLE dictionary
+  -maxFourierImplicit X
+                     Fourier number limit for -implicitEnergy runs
+                     (default: the case maxFourier)
+  -physTol X         relative tolerance for the physics checks
+  -tol X             allowed relative slowdown against the baseline (default: $TOL)
+  -errTol X          allowed change in the physics error against the baseline
+                     (default: $ERRTOL)
+  -baseline FILE     baseline results (default: baselines/<hostname>.csv)
+  -update-baseline   store the results as the new baseline
+  -build             build the solver with Allwmake.sh first
+  -out DIR           run directory (default: run)
+  -help              print this message
+
+Results are written to <out>/benchmark.csv as case,nProcs,scale,metric,value rows.
+
+USAGE
+	exit 1
+}
+
+while [ "$#" -gt 0 ]
+do
+	case "$1" in
+		-cases)           CASES="$2"; shift ;;
+		-np)              NPROCS="$2"; shift ;;
+		-scale)           SCALES="$2"; shift ;;
+		-weak)            WEAK=yes ;;
+		-steps)           STEPS="$2"; shift ;;
+		-warmup)          WARMUP="$2"; shift ;;
+		-accuracy)        ACCURACY=yes ;;
+		-endTime)         ENDTIME="$2"; shift ;;
+		-implicitEnergy)  IMPLICITENERGY=yes ;;
+		-maxFourierImplicit) MAXFOURIERIMPLICIT="$2"; shift ;;
+		-physTol)         PHYSTOL="$2"; shift ;;
+		-tol)             TOL="$2"; shift ;;
+		-errTol)          ERRTOL="$2"; shift ;;
+		-baseline)        BASELINE="$2"; shift ;;
+		-update-baseline) UPDATEBASELINE=yes ;;
+		-build)           BUILD=yes ;;
+		-out)             OUTDIR="$2"; shift ;;
+		-h | -help)       usage ;;
+		*)                echo "Unknown option: $1"; usage ;;
+	esac
+	shift
+done
+
+if [ -z "$WM_PROJECT_DIR" ]
+then
+	echo "The OpenFOAM environment is not set"
+	exit 1
+fi
+
+mkdir -p $OUTDIR
+OUTDIR=`cd $OUTDIR && pwd`
+RESULTS=$OUTDIR/benchmark.csv
+SUMMARY=$OUTDIR/Summary.log
+echo "case,nProcs,scale,metric,value" > $RESULTS
+rm -f $SUMMARY
+
+report()
+{
+	echo "$1"
+	echo "$1" >> $SUMMARY
+}
+
+#Build check
+if [ "$BUILD" = yes ]
+then
+	(cd $BENCHDIR/.. && ./Allwmake.sh > $OUTDIR/log.Allwmake 2>&1)
+	if grep -q Error $OUTDIR/log.Allwmake
+	then
+		report "Build check: FAIL (see $OUTDIR/log.Allwmake)"
+		exit 1
+	fi
+	report "Build check: PASS"
+fi
+
+#The tutorial a case is built from
+tutorialOf()
+{
+	if [ -f $BENCHDIR/cases/$1/baseTutorial ]
+	then
+		cat $BENCHDIR/cases/$1/baseTutorial
+	else
+		echo $1
+	fi
+}
+
+#Axisymmetric cases have their wedge mesh built by makeAxialMesh, unless the
+#case variant brings its own mesh
+axisymmetric()
+{
+	[ -f $TUTORIALS/`tutorialOf $1`/system/rotationDict ] && \
+	[ ! -f $BENCHDIR/cases/$1/constant/polyMesh/blockMeshDict ]
+}
+
+#Runs an application with its output going to log.<application>
+runStep()
+{
+	"$@" > log.$1 2>&1 || { echo "$1 failed, see `pwd`/log.$1"; return 1; }
+}
+
+#Lists the tools a case needs that are not installed
+missingTools()
+{
+	local CASE=$1 NP=$2
+	local TUTORIAL=$TUTORIALS/`tutorialOf $CASE`
+	local TOOLS="blockMesh checkMesh $SOLVER"
+	[ -f $TUTORIAL/constant/polyMesh/blockMeshDict.m4 ] && TOOLS="$TOOLS m4"
+	axisymmetric $CASE && TOOLS="$TOOLS makeAxialMesh collapseEdges"
+	[ -f $TUTORIAL/system/setFieldsDict ] && TOOLS="$TOOLS setFields"
+	[ -f $TUTORIAL/system/funkySetFieldsDict ] && TOOLS="$TOOLS funkySetFields"
+	[ "$NP" -gt 1 ] && TOOLS="$TOOLS decomposePar $MPIRUN"
+	for TOOL in $TOOLS
+	do
+		command -v $TOOL > /dev/null || echo -n "$TOOL "
+	done
+
+	#Libraries loaded by the controlDict (e.g. swak4Foam), searched for on the
+	#library path that the OpenFOAM environment sets up
+	local CONTROLDICT=$TUTORIAL/system/controlDict
+	[ -f $BENCHDIR/cases/$CASE/system/controlDict ] && CONTROLDICT=$BENCHDIR/cases/$CASE/system/controlDict
+	local LIB DIR FOUND
+	for LIB in `sed 's://.*$::' $CONTROLDICT | grep -o 'lib[A-Za-z0-9_]*\.so' | sort -u`
+	do
+		FOUND=no
+		for DIR in ${LD_LIBRARY_PATH//:/ }
+		do
+			[ -f $DIR/$LIB ] && { FOUND=yes; break; }
+		done
+		[ $FOUND = yes ] || echo -n "$LIB "
+	done
+}
+
+#Multiplies the cell counts of all blocks in blockMeshDict by the scale factor
+#Counts of 1 (the empty and wedge directions) are kept
+scaleBlockMesh()
+{
+	awk -v s=$1 '
+	/^[ \t]*hex[ \t]*\(/ {
+		if (match($0, /\)[ \t]*\([ \t]*[0-9]+[ \t]+[0-9]+[ \t]+[0-9]+[ \t]*\)/))
+		{
+			pre = substr($0, 1, RSTART)
+			post = substr($0, RSTART + RLENGTH)
+			cells = substr($0, RSTART + 1, RLENGTH - 1)
+			gsub(/[()]/, "", cells)
+			n = split(cells, c, " ")
+			out = ""
+			for (i = 1; i <= n; i++)
+			{
+				if (c[i] > 1)
+				{
+					c[i] = int(c[i]*s + 0.5)
+					if (c[i] < 1) {  c[i] = 1  }
+				}
+				out = out " " c[i]
+			}
+			$0 = pre " (" substr(out, 2) ")" post
+		}
+	}
+	{ print }' constant/polyMesh/blockMeshDict > constant/polyMesh/blockMeshDict.scaled
+	mv constant/polyMesh/blockMeshDict.scaled constant/polyMesh/blockMeshDict
+}
+
+#Builds the mesh and initial fields of a case in the current directory,
+#following the tutorial InitScript.sh without installing anything
+setupCase()
+{
+	local CASE=$1 MESHSCALE=$2
+	local TUTORIAL=$TUTORIALS/`tutorialOf $CASE`
+	cp -r $TUTORIAL/A $TUTORIAL/system .
+	mkdir -p constant/polyMesh
+	find $TUTORIAL/constant -maxdepth 1 -type f -exec cp {} constant/ \;
+	cp $TUTORIAL/constant/polyMesh/blockMeshDict* constant/polyMesh/
+	if [ -d $BENCHDIR/cases/$CASE ]
+	then
+		for DIR in constant system
+		do
+			[ -d $BENCHDIR/cases/$CASE/$DIR ] && cp -r $BENCHDIR/cases/$CASE/$DIR .
+		done
+		axisymmetric $CASE || rm -f system/rotationDict
+	fi
+
+	if [ -f constant/polyMesh/blockMeshDict.m4 ]
+	then
+		m4 constant/polyMesh/blockMeshDict.m4 > constant/polyMesh/blockMeshDict
+	fi
+	scaleBlockMesh $MESHSCALE
+	runStep blockMesh || return 1
+	if axisymmetric $CASE
+	then
+		runStep makeAxialMesh -overwrite || return 1
+		runStep collapseEdges -overwrite || return 1
+	fi
+	runStep checkMesh || return 1
+
+	mkdir -p 0
+	cp -r A/* 0/
+	[ -f 0/alpha1.org ] && mv 0/alpha1.org 0/alpha1
+	if [ -f system/funkySetFieldsDict ]
+	then
+		runStep funkySetFields -time 0 -allowFunctionObjects || return 1
+	fi
+	if [ -f system/setFieldsDict ]
+	then
+		runStep setFields || return 1
+	fi
+	return 0
+}
+
+#Sets up the run controls: a fixed number of steps at a fixed time step
+#(scaled with the mesh) for performance runs, the case controls otherwise
+setupControls()
+{
+	local MESHSCALE=$1
+	{
+		echo
+		echo "//Benchmark settings, added by benchmarks/Allrun.sh"
+		echo "startFrom       startTime;"
+		echo "startTime       0;"
+		echo "stopAt          endTime;"
+		echo "StageTimers     yes;"
+	} >> system/controlDict
+
+	if [ "$IMPLICITENERGY" = yes ]
+	then
+		{
+			echo
+			echo "//Benchmark settings, added by benchmarks/Allrun.sh"
+			echo "PIMPLE"
+			echo "{"
+			echo "    implicitEnergy  yes;"
+			echo "}"
+		} >> system/fvSolution
+		[ -n "$MAXFOURIERIMPLICIT" ] && echo "maxFourierImplicit $MAXFOURIERIMPLICIT;" >> system/controlDict
+	fi
+
+	if [ "$ACCURACY" = yes ]
+	then
+		[ -n "$ENDTIME" ] && echo "endTime         $ENDTIME;" >> system/controlDict
+		return
+	fi
+
+	local DT=`awk '$1 == "deltaT" { sub(";", "", $2); print $2; exit }' system/controlDict`
+	DT=`awk -v dt=$DT -v s=$MESHSCALE 'BEGIN { printf "%.6g", dt/s }'`
+	cat >> system/controlDict <<CONTROLS
+deltaT          $DT;
+endTime         `awk -v dt=$DT -v n=$STEPS 'BEGIN { printf "%.10g", dt*n }'`;
+adjustTimeStep  no;
+writeControl    timeStep;
+writeInterval   $((STEPS + 1));
+functions       ( );
+CONTROLS
+}
+
+#Writes the metrics of a finished run as CSV rows
+collectMetrics()
+{
+	local KEY=$1
+	local NCELLS=`awk '$1 == "cells:" { print $2; exit }' log.checkMesh`
+	echo "$KEY,nCells,$NCELLS" >> $RESULTS
+
+	local TIMERS=`ls postProcessing/stageTimers/*/stageTimers.csv 2> /dev/null | head -1`
+	if [ -n "$TIMERS" ]
+	then
+		awk -v warmup=$WARMUP -f $BENCHDIR/summarizeTimers.awk $TIMERS | \
+		awk -v key="$KEY" '
+			{ print key "," $1 "," $2 }
+			$1 == "TimeStep_max" { print key ",stepTime," $2 }' >> $RESULTS
+	fi
+
+	awk -v key="$KEY" '
+		/ClockTime =/ { for (i = 1; i < NF; i++) if ($i == "ClockTime") wall = $(i + 2) }
+		/^Peak resident set size/ { rssMax = $7; rssTotal = $11 }
+		END {
+			if (wall != "") print key ",wallTime," wall
+			if (rssMax != "") print key ",peakRSSMax," rssMax "\n" key ",peakRSSTotal," rssTotal
+		}' log.$SOLVER >> $RESULTS
+}
+
+#Checks the case output against the analytical solutions
+checkPhysics()
+{
+	local CASE=$1 KEY=$2 SCRIPT DATA
+	case $CASE in
+		Stefan)             SCRIPT=checkStefan.awk;  DATA=LiquidAccumulation.dat ;;
+		NusseltSmooth)      SCRIPT=checkNusselt.awk; DATA=WallHeatFlux.dat ;;
+		NusseltWavy)        SCRIPT=checkWavy.awk;    DATA=WallHeatFlux.dat ;;
+		BubbleCondensation) SCRIPT=checkCond.awk;    DATA=Bubble_Condensation.dat ;;
+		*)                  return 0 ;;
+	esac
+	if [ ! -f $DATA ]
+	then
+		report "    Physics check: SKIP (no $DATA)"
+		return 0
+	fi
+	awk -f $BENCHDIR/checks/$SCRIPT $DATA > log.check
+	local ERR=`awk '$1 == "physicsError" { print $2 }' log.check`
+	grep -v physicsError log.check | sed 's/^/    /' | tee -a $SUMMARY
+	if [ -z "$ERR" ]
+	then
+		report "    Physics check: SKIP (run too short)"
+		return 0
+	fi
+	echo "$KEY,physicsError,$ERR" >> $RESULTS
+	local TOLCASE=`physicsTol $CASE`
+	if awk -v e=$ERR -v t=$TOLCASE 'BEGIN { exit !(e <= t) }'
+	then
+		report "    Physics check: PASS (error $ERR, tolerance $TOLCASE)"
+	else
+		report "    Physics check: FAIL (error $ERR, tolerance $TOLCASE)"
+		return 1
+	fi
+}
+
+#Sets up, runs, and evaluates one case on NP processors at one mesh scale
+runCase()
+{
+	local CASE=$1 NP=$2 SCALE=$3
+	local MESHSCALE=$SCALE
+	if [ "$WEAK" = yes ]
+	then
+		MESHSCALE=`awk -v s=$SCALE -v n=$NP 'BEGIN { printf "%.6g", s*sqrt(n) }'`
+	fi
+	local KEY="$CASE,$NP,$SCALE"
+	local DIR=$OUTDIR/$CASE/np${NP}_scale${SCALE}
+
+	local MISSING=`missingTools $CASE $NP`
+	if [ -n "$MISSING" ]
+	then
+		report "$CASE np=$NP scale=$SCALE: SKIP (missing $MISSING)"
+		echo "$KEY,status,SKIP" >> $RESULTS
+		return 0
+	fi
+
+	rm -rf $DIR
+	mkdir -p $DIR
+	cd $DIR
+	#The axisymmetric cases are run with floating point traps off, as in the tutorials
+	axisymmetric $CASE && unset FOAM_SIGFPE
+
+	if ! setupCase $CASE $MESHSCALE
+	then
+		report "$CASE np=$NP scale=$SCALE: FAIL (case setup)"
+		echo "$KEY,status,FAIL" >> $RESULTS
+		return 1
+	fi
+	setupControls $MESHSCALE
+
+	local STATUS=OK
+	if [ "$NP" -gt 1 ]
+	then
+		{
+			echo "numberOfSubdomains $NP;"
+			echo "method          scotch;"
+		} >> system/decomposeParDict
+		runStep decomposePar -force || STATUS=FAIL
+		[ $STATUS = OK ] && { $MPIRUN -np $NP $SOLVER -parallel > log.$SOLVER 2>&1 || STATUS=FAIL; }
+	else
+		$SOLVER > log.$SOLVER 2>&1 || STATUS=FAIL
+	fi
+	[ $STATUS = OK ] && ! grep -q "^End" log.$SOLVER && STATUS=FAIL
+
+	echo "$KEY,status,$STATUS" >> $RESULTS
+	collectMetrics $KEY
+	local STEPTIME=`awk -F, -v key="$KEY" '$1 "," $2 "," $3 == key && $4 == "stepTime" { print $5 }' $RESULTS`
+	report "$CASE np=$NP scale=$SCALE: $STATUS (${STEPTIME:--} s/step, log in $DIR)"
+
+	if [ $STATUS = OK ] && [ "$ACCURACY" = yes ]
+	then
+		checkPhysics $CASE $KEY || return 1
+	fi
+	[ $STATUS = OK ]
+}
+
+NFAIL=0
+for CASE in $CASES
+do
+	if [ ! -d $TUTORIALS/`tutorialOf $CASE` ]
+	then
+		report "$CASE: no such tutorial"
+		NFAIL=$((NFAIL + 1))
+		continue
+	fi
+	for SCALE in $SCALES
+	do
+		for NP in $NPROCS
+		do
+			(runCase $CASE $NP $SCALE) || NFAIL=$((NFAIL + 1))
+		done
+	done
+done
+
+#Speedup and parallel efficiency against the smallest processor count; for
+#weak scaling the ideal time per step is constant, so the efficiency is t1/t
+report ""
+awk -F, -v weak=$WEAK '$4 == "stepTime" {
+		run = $1 "," $3
+		if (!(run in t1) || $2 < np1[run]) {  t1[run] = $5;  np1[run] = $2  }
+		n++;  name[n] = $1;  np[n] = $2;  scale[n] = $3;  t[n] = $5
+	}
+	END {
+		printf "%-20s %6s %6s %12s %8s %10s\n", "Case", "nProcs", "scale", "step [s]", "speedup", "efficiency"
+		for (i = 1; i <= n; i++)
+		{
+			run = name[i] "," scale[i]
+			s = t1[run]/t[i]
+			e = (weak == "yes") ? s : s*np1[run]/np[i]
+			printf "%-20s %6s %6s %12.4g %8.3f %10.3f\n", name[i], np[i], scale[i], t[i], s, e
+		}
+	}' $RESULTS | tee -a $SUMMARY
+
+#Baseline comparison
+report ""
+if [ "$UPDATEBASELINE" = yes ]
+then
+	mkdir -p `dirname $BASELINE` && cp $RESULTS $BASELINE
+	report "Baseline updated: $BASELINE"
+elif [ -f "$BASELINE" ]
+then
+	report "Comparison with $BASELINE (tolerance $TOL, physics error tolerance $ERRTOL):"
+	awk -F, -v tol=$TOL -v errTol=$ERRTOL -f $BENCHDIR/compareBaseline.awk $BASELINE $RESULTS | tee -a $SUMMARY
+	[ "${PIPESTATUS[0]}" -ne 0 ] && NFAIL=$((NFAIL + 1))
+else
+	report "No baseline at $BASELINE, so nothing was compared; run the pre-series"
+	report "build with -update-baseline to store one (see the Benchmarks section of README.md)"
+fi
+
+report ""
+report "Results: $RESULTS"
+if [ $NFAIL -gt 0 ]
+then
+	report "Benchmark suite: FAIL"
+	exit 1
+fi
+report "Benchmark suite: PASS"
@@ -0,0 +1,60 @@
+#Testing script for Rising condensing bubble case, awk port of
+#tutorials/BubbleCondensation/CheckCond.m
+#Usage: awk [-v tStart=0.05] -f checkCond.awk Bubble_Condensation.dat
+BEGIN {
+	if (tStart == "") {  tStart = 0.05  }
+	pi = atan2(0, -1)
+
+	#Some constants
+	DeltaT      = 1                 #K
+
+	#Geometry info
+	theta_wedge = 5                 #deg, Axisymmetric wedge angle
+	Vol_tot     = 1.961e-10         #m^3, domain volume
+
+	#Fluid material properties
+	rho_L       = 900               #kg/m^3
+	k_L         = 1                 #W/m-K
+	cp_L        = 2000              #J/kg-K
+	mu_L        = 5.0E-6 * rho_L    #kg/m-s
+	Pr_L        = mu_L*cp_L/k_L     #-, Liquid Prandtl number
+	U_domain    = 0                 #m/s
+}
+
+#Trim the startup period
+NF >= 4 && $1 > tStart && $3 > 0 {
+	Q     = $2                      #W
+	VF    = $3                      #-, bubble void fraction
+	U_bub = $4 + U_domain           #m/s
+	if (U_bub < 0) {  U_bub = -U_bub  }
+
+	#Bubble properties
+	Vol_bub = VF*Vol_tot*(360/theta_wedge)
+	D_bub   = ((6/pi)*Vol_bub)^(1/3)
+	Re_bub  = rho_L*U_bub*D_bub/mu_L
+	A_bub   = pi*D_bub^2
+	H_sim   = (360/theta_wedge)*Q/(A_bub*DeltaT)
+
+	#Analytical model, Ranz and Marshall (1952)
+	Nu_an   = 2 + 0.6*Re_bub^0.5 * Pr_L^0.33
+	H_an    = Nu_an*k_L/D_bub
+
+	err = (H_sim - H_an)/H_an
+	if (err < 0) {  err = -err  }
+	sum_H_sim += H_sim
+	sum_H_an  += H_an
+	sum_err   += err
+	n++
+}
+
+END {
+	if (n == 0)
+	{
+		print "No bubble data found after t = " tStart " s"
+		exit 2
+	}
+	printf "H_avg simulation: %g W/m^2-K\n", sum_H_sim/n
+	printf "H_avg analytical: %g W/m^2-K\n", sum_H_an/n
+	printf "Average simulation error: %g\n", sum_err/n
+	printf "physicsError %g\n", sum_err/n
+}
@@ -0,0 +1,49 @@
+#Testing script for Nusselt falling film wall heat flux results, awk port of
+#tutorials/NusseltSmooth/CheckNusselt.m
+#Usage: awk [-v tStart=0.1] -f checkNusselt.awk WallHeatFlux.dat
+BEGIN {
+	if (tStart == "") {  tStart = 0.1  }
+
+	#Some constants
+	g      = 9.81                   #m/s^2
+	DeltaT = 5                      #K
+
+	#Fluid material properties
+	rho_L  = 500                    #kg/m^3
+	rho_V  = 20                     #kg/m^3
+	k_L    = 0.5                    #W/m-K
+	mu_L   = 1.0E-6 * rho_L         #kg/m-s
+}
+
+NF >= 4 {
+	n++
+	t[n] = $1;  dt[n] = $2;  q_w_sim[n] = $3;  Re_f_sim[n] = $4
+	#Trim the startup period, starting from the last entry before tStart
+	if ($1 < tStart) {  first = n  }
+}
+
+END {
+	if (first == 0) {  first = 1  }
+	for (i = first; i <= n; i++)
+	{
+		#Smooth falling film result
+		delta_an = (3*mu_L^2/(4*rho_L*(rho_L-rho_V)*g))^(1/3) * Re_f_sim[i]^(1/3)
+		q_w_an   = DeltaT*k_L/delta_an
+		sum_dt    += dt[i]
+		sum_q_an  += dt[i]*q_w_an
+		sum_q_sim += dt[i]*q_w_sim[i]
+	}
+	if (n == 0 || sum_dt <= 0 || t[n] <= tStart)
+	{
+		print "No wall heat flux data found after t = " tStart " s"
+		exit 2
+	}
+	q_avg_an  = sum_q_an/sum_dt
+	q_avg_sim = sum_q_sim/sum_dt
+	err = (q_avg_sim - q_avg_an)/q_avg_an
+	if (err < 0) {  err = -err  }
+	printf "Q_avg simulation: %g W/m^2\n", q_avg_sim
+	printf "Q_avg analytical: %g W/m^2\n", q_avg_an
+	printf "Relative error: %g\n", err
+	printf "physicsError %g\n", err
+}
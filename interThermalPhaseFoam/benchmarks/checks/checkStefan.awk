@@ -0,0 +1,42 @@
+#Testing script for Stefan Problem, awk port of tutorials/Stefan/CheckStefan.m
+#Usage: awk -f checkStefan.awk LiquidAccumulation.dat
+BEGIN {
+	#Fluid material properties (iso-butane 25 C)
+	rho_L = 550.6                   #kg/m^3
+	k_L   = 0.0892                  #W/m-K
+	c_L   = 2446                    #J/kgK
+	a_L   = k_L/(rho_L*c_L)         #m^2/s
+	L     = 329365                  #J/kg
+
+	#Boundary Conditions
+	Tsat  = 298                     #Saturated temperature [K]
+	Tw    = 293                     #Wall temperature [K]
+}
+
+NF >= 3 {
+	t         = $1                  #s
+	dt        = $2                  #s
+	delta_sim = $3                  #m
+
+	#Analytical solution for interface position
+	delta_an  = sqrt(2*t*a_L/(0.5 + L/(c_L*(Tsat-Tw))))
+
+	delta_t_int_sim += dt*delta_sim
+	delta_t_int_an  += dt*delta_an
+	n++
+}
+
+END {
+	if (n == 0 || delta_t_int_an <= 0)
+	{
+		print "No film thickness data found"
+		exit 2
+	}
+	err = delta_t_int_sim - delta_t_int_an
+	if (err < 0) {  err = -err  }
+	err = err/delta_t_int_an
+	printf "Final Interface position simulation: %g m\n", delta_sim
+	printf "Final Interface position analytical: %g m\n", delta_an
+	printf "Relative integrated error: %g\n", err
+	printf "physicsError %g\n", err
+}
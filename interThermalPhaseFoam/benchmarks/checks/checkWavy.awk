@@ -0,0 +1,56 @@
+#Testing script for wavy falling film wall heat flux results, awk port of
+#tutorials/NusseltWavy/CheckWavy.m
+#The reported error is the smaller of the deviations from the two correlations
+#Usage: awk [-v tStart=0.5] -f checkWavy.awk WallHeatFlux.dat
+BEGIN {
+	if (tStart == "") {  tStart = 0.5  }
+
+	#Some constants
+	g      = 9.81                   #m/s^2
+	DeltaT = 5                      #K
+
+	#Fluid material properties (iso-butane 25 C)
+	rho_L  = 550.6                  #kg/m^3
+	rho_V  = 9.12                   #kg/m^3
+	k_L    = 0.0892                 #W/m-K
+	mu_L   = 2.74E-7 * rho_L        #kg/m-s
+}
+
+NF >= 4 {
+	n++
+	t[n] = $1;  dt[n] = $2;  q_w_sim[n] = $3;  Re_f_sim[n] = $4
+	#Trim the startup period, starting from the last entry before tStart
+	if ($1 < tStart) {  first = n  }
+}
+
+END {
+	if (first == 0) {  first = 1  }
+	H_scale = k_L*(mu_L^2/(g*rho_L*(rho_L-rho_V)))^(-1/3)
+	for (i = first; i <= n; i++)
+	{
+		q_w_anA = H_scale * 0.82 * Re_f_sim[i]^(-0.22) * DeltaT    #Edwards et al. (1979)
+		q_w_anB = H_scale * 1.76 * Re_f_sim[i]^(-1/3) * DeltaT     #Fujita and Ueda (1978)
+		sum_dt    += dt[i]
+		sum_q_anA += dt[i]*q_w_anA
+		sum_q_anB += dt[i]*q_w_anB
+		sum_q_sim += dt[i]*q_w_sim[i]
+	}
+	if (n == 0 || sum_dt <= 0 || t[n] <= tStart)
+	{
+		print "No wall heat flux data found after t = " tStart " s"
+		exit 2
+	}
+	q_avg_anA = sum_q_anA/sum_dt
+	q_avg_anB = sum_q_anB/sum_dt
+	q_avg_sim = sum_q_sim/sum_dt
+	errA = (q_avg_sim - q_avg_anA)/q_avg_anA
+	if (errA < 0) {  errA = -errA  }
+	errB = (q_avg_sim - q_avg_anB)/q_avg_anB
+	if (errB < 0) {  errB = -errB  }
+	printf "Q_avg simulation: %g W/m^2\n", q_avg_sim
+	printf "Q_avg analytical: %g W/m^2 (Edwards et al., 1979)\n", q_avg_anA
+	printf "     Relative error: %g\n", errA
+	printf "Q_avg analytical: %g W/m^2 (Fujita and Ueda, 1978)\n", q_avg_anB
+	printf "     Relative error: %g\n", errB
+	printf "physicsError %g\n", (errA < errB) ? errA : errB
+}
@@ -0,0 +1,93 @@
+#Compares a benchmark results file against a stored baseline
+#Both files hold "case,nProcs,scale,metric,value" rows. A run fails when its
+#time per step or peak memory grows by more than the relative tolerance 'tol',
+#or when it ran in the baseline but not now. With -accuracy results, a run also
+#fails when its physics error moves by more than the absolute tolerance 'errTol'
+#from the baseline, so a solver change can be checked against the results of
+#the previous build. Changes in solver iterations and slower stages are
+#reported as warnings. Exits with 1 on any failure.
+#Usage: awk -F, -v tol=0.1 -v errTol=0.005 -f compareBaseline.awk baseline.csv results.csv
+function rel(a, b)
+{
+	if (b == 0) {  return (a == 0) ? 0 : 1  }
+	return (a - b)/b
+}
+
+BEGIN {
+	if (errTol == "")
+	{  errTol = 0.005  }
+}
+
+/^#/ || $1 == "case" { next }
+
+#First file: the baseline
+FNR == NR {
+	base[$1 FS $2 FS $3 FS $4] = $5
+	next
+}
+
+{
+	run = $1 FS $2 FS $3
+	key = run FS $4
+	if (!(run in seen))
+	{
+		seen[run] = 1
+		runs[++nRuns] = run
+	}
+	if (!(key in base))
+	{  next  }
+
+	if ($4 == "status")
+	{
+		if (base[key] == "OK" && $5 != "OK")
+		{  fail[run] = fail[run] " status=" $5  }
+		next
+	}
+
+	if ($4 == "physicsError")
+	{
+		d = $5 - base[key]
+		if (d > errTol || d < -errTol)
+		{  fail[run] = fail[run] sprintf(" physicsError%+.4f", d)  }
+		next
+	}
+
+	r = rel($5, base[key])
+	if ($4 == "stepTime")
+	{
+		stepTime[run] = $5
+		ratio[run] = $5/base[key]
+	}
+	if (($4 == "stepTime" || $4 == "peakRSSMax") && r > tol)
+	{  fail[run] = fail[run] sprintf(" %s+%.0f%%", $4, 100*r)  }
+	else if ($4 ~ /_iter$/ && (r > tol || r < -tol))
+	{  warn[run] = warn[run] sprintf(" %s%+.0f%%", $4, 100*r)  }
+	else if ($4 ~ /_max$/ && $4 != "TimeStep_max" && r > tol && base[key] > 0.01*base[run FS "stepTime"])
+	{  warn[run] = warn[run] sprintf(" %s+%.0f%%", $4, 100*r)  }
+}
+
+END {
+	printf "%-20s %6s %6s %12s %8s  %s\n", "Case", "nProcs", "scale", "step [s]", "ratio", "result"
+	for (i = 1; i <= nRuns; i++)
+	{
+		run = runs[i]
+		split(run, f, FS)
+		if (!((run FS "status") in base))
+		{  result = "NEW"  }
+		else if (run in fail)
+		{
+			result = "FAIL" fail[run]
+			nFail++
+		}
+		else
+		{  result = "PASS"  }
+		if (run in warn)
+		{  result = result ", WARN" warn[run]  }
+		if (run in ratio)
+		{  printf "%-20s %6s %6s %12.4g %8.3f  %s\n", f[1], f[2], f[3], stepTime[run], ratio[run], result  }
+		else
+		{  printf "%-20s %6s %6s %12s %8s  %s\n", f[1], f[2], f[3], "-", "-", result  }
+	}
+	if (nFail > 0)
+	{  exit 1  }
+}
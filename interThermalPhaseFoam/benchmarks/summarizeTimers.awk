@@ -0,0 +1,34 @@
+#Averages the per-step wall times and solver iterations of a stageTimers.csv
+#log over all steps after the first 'warmup' steps, and prints one
+#"name value" line per column (the _min columns are left out)
+#Usage: awk -v warmup=10 -f summarizeTimers.awk stageTimers.csv
+BEGIN { FS = "," }
+
+/^#/ { next }
+
+nCols == 0 {
+	for (i = 2; i <= NF; i++)
+	{  name[i] = $i;  }
+	nCols = NF
+	next
+}
+
+{
+	nRows++
+	if (nRows <= warmup)
+	{  next  }
+	n++
+	for (i = 2; i <= nCols; i++)
+	{  sum[i] += $i  }
+}
+
+END {
+	if (n == 0)
+	{  exit 1  }
+	print "nSteps", n
+	for (i = 2; i <= nCols; i++)
+	{
+		if (name[i] !~ /_min$/)
+		{  printf "%s %.6g\n", name[i], sum[i]/n  }
+	}
+}